@@ -8,15 +8,19 @@
 #include "pico/stdlib.h"     // Funcionalidades básicas do RP2040
 #include "pico/cyw43_arch.h"
 #include "pico/bootrom.h"    // Para entrar no modo bootsel ao pressionar o botão B
+#include "pico/stdio_usb.h"  // Para aguardar o terminal USB no benchmark do display
 
 // Bibliotecas do pico SDK de hardware
 #include "hardware/i2c.h"    // Comunicação I2C
 #include "hardware/pio.h"    // Controle da matriz de LEDs por PIO
 #include "hardware/adc.h"    // Conversor analógico-digital
 #include "hardware/clocks.h" // Controle dos clocks do sistema (PIO)
+#include "hardware/dma.h"    // Captura em rajada do ADC para o capacímetro
 
 #include "inc/ssd1306.h" // Header para controle do display OLED
 #include "inc/font.h"    // Header para a fonte do display OLED
+#include "inc/capacimetro.h" // Header para o ajuste da curva de carga RC
+#include "inc/func_ram.h"    // Colocação das rotinas críticas (SRAM ou flash)
 
 #include "ws2812.pio.h"  // Header para controle dos LEDs WS2812
 
@@ -32,11 +36,23 @@
 #define I2C_SCL 15    // Pino de clock
 #define ADDRESS 0x3C  // Endereço do display
 
+// Benchmark do display no alvo (genérico x geometria fixa), exibido via USB na inicialização.
+// Compilado pelo alvo Ohmimetro_bench_display, com os dois drivers executando da flash
+#ifndef BENCH_DISPLAY
+#define BENCH_DISPLAY 0         // 1 para habilitar
+#endif
+#define BENCH_REPETICOES 1000   // Quadros desenhados em cada medição
+
+#if BENCH_DISPLAY && FUNCOES_NA_RAM
+#error "BENCH_DISPLAY requer FUNCOES_NA_RAM 0 (genérico e geometria fixa na mesma memória)"
+#endif
+
 // Definições da matriz de LEDs
 #define NUM_PIXELS 25 // Número total de LEDs na matriz
 #define WS2812_PIN 7  // Pino da matriz de LEDs
 
-// Configuração do botão
+// Configuração dos botões
+#define BUTTON_A 5 // Pino do botão A (alterna entre ohmímetro e capacímetro)
 #define BUTTON_B 6 // Pino do botão B
 
 // Configuração para o ohmímetro
@@ -44,6 +60,40 @@
 #define ADC_VREF 3.30f      // Tensão de referência do ADC
 #define ADC_RESOLUTION 4095 // Resolução do ADC (12 bits)
 #define R_CONHECIDO 9920    // Resistor conhecido
+#define TOPO_AMOSTRAS 256   // Leituras na calibração do nível do divisor (pontas abertas)
+#define TOPO_MINIMO 3700    // Calibração abaixo disso indica resistor nas pontas e é descartada
+
+// Configuração da detecção rápida do estado das pontas
+#define PONTA_AMOSTRAS 32          // Número de leituras rápidas usadas na classificação
+#define PONTA_LIMIAR_CURTO 2       // Média do ADC abaixo disso indica curto (< ~5 ohms; 10 ohms = 4 contagens)
+#define PONTA_MARGEM_ABERTO 15     // Média a menos disso do nível do divisor indica pontas abertas (~2.7 Mohms)
+#define PONTA_MARGEM_FORA 42       // Média a menos disso do nível do divisor indica fora da faixa (~1 Mohm)
+#define PONTA_HISTERESE 2          // Contagens para sair do estado atual nos limiares de fora/aberto
+#define PONTA_HISTERESE_CURTO 1    // Contagens para sair do estado atual no limiar de curto
+#define R_MAXIMO 999999            // Maior resistência que cabe no campo de 6 dígitos
+#define PONTA_CONFIRMACOES 3       // Classificações iguais seguidas para aceitar uma inserção
+#define PONTA_INTERVALO_MS 5       // Intervalo entre verificações das pontas
+#define PONTA_VARIACAO 3           // Variação da média rápida (contagens) que dispara uma nova leitura
+#define PONTA_RELEITURA_MS 5000    // Releitura periódica de um resistor que não mudou
+
+// Medição de jitter (tempo de execução das rotinas críticas, sem sleep no trecho medido).
+// Compilada pelos alvos Ohmimetro_bench_ram e Ohmimetro_bench_flash, que diferem só na colocação
+#ifndef MEDIR_JITTER
+#define MEDIR_JITTER 0    // 1 para habilitar
+#endif
+#define JITTER_QUADROS 12 // Quadros medidos antes do relatório (único)
+
+// Configuração para o capacímetro
+#define DIVISOR_PIN 16           // GPIO que alimenta o R_CONHECIDO (degrau de carga)
+#define CAP_AMOSTRAS 4096        // Tamanho da rajada de captura
+#define CAP_PERIODO_US 2.0f      // Período de amostragem na taxa máxima (500 ksps)
+#define CAP_ESCALAS 3            // Número de taxas de amostragem tentadas (÷1, ÷10, ÷100)
+#define CAP_DESCARGA_MS 1000     // Tempo máximo de espera pela descarga do capacitor
+#define CAP_LIMIAR_DESCARGA 4    // Leitura do ADC considerada descarregada
+#define CAP_PLATO_JANELAS 3      // Espera após a captura (em janelas) antes de ler o platô
+#define CAP_PLATO_AMOSTRAS 16    // Leituras usadas na média do platô
+#define CAP_SUBINDO_PCT 85       // Última amostra abaixo disso (% do nível do divisor): curva ainda subindo
+#define ARENA_BYTES (CAP_AMOSTRAS * sizeof(uint16_t)) // Memória reservada para buffers de trabalho
 
 // ---------------- Definições - Fim ----------------
 
@@ -52,6 +102,19 @@
 // ---------------- Variáveis - Início ----------------
 
 static volatile uint32_t last_time = 0; // Armazena o último tempo registrado nas interrupções
+static volatile bool modo_capacimetro = false; // Modo atual (alternado pelo botão A)
+
+// Nível alto do GPIO do divisor visto pelo ADC (contagens). O GPIO e a referência do ADC
+// são fontes diferentes, então o topo do divisor não é exatamente o fundo de escala
+static uint16_t nivel_topo = ADC_RESOLUTION;
+
+// Arena estática para buffers de trabalho (alocada uma vez e reutilizada)
+static uint8_t arena[ARENA_BYTES] __attribute__((aligned(4)));
+static size_t arena_usado = 0;
+
+// Variáveis do capacímetro
+static uint16_t *cap_buffer; // Buffer da rajada de captura (na arena)
+static int cap_dma;          // Canal DMA usado na captura
 
 // Variáveis da matriz de LEDs
 static volatile uint32_t leds[NUM_PIXELS]; // Buffer de cores para cada LED
@@ -78,6 +141,32 @@ static const Color resistor_colors[10] = {
     {8, 8, 8}   // 9 - Branco
 };
 
+// Estados possíveis das pontas de prova
+typedef enum {
+    PONTA_ABERTA,     // Nenhum resistor conectado
+    PONTA_CURTO,      // Pontas em curto
+    PONTA_NA_FAIXA,   // Resistor presente e mensurável
+    PONTA_FORA_FAIXA  // Resistor presente, mas acima da faixa de medição
+}EstadoPonta;
+
+// Textos exibidos no campo de resistência para cada estado das pontas
+static const char *nome_estados[4] = {
+    "aberto", // PONTA_ABERTA
+    "curto ", // PONTA_CURTO
+    "",       // PONTA_NA_FAIXA (exibe o valor medido)
+    "fora  "  // PONTA_FORA_FAIXA
+};
+
+#if MEDIR_JITTER
+// Estatística do tempo de execução de uma rotina (us)
+typedef struct {
+    uint32_t min, max, n;
+}Jitter;
+
+static Jitter jitter_amostragem = {UINT32_MAX, 0, 0}; // Rajada de leituras da detecção das pontas
+static Jitter jitter_desenho = {UINT32_MAX, 0, 0};    // Desenho do valor e das faixas no framebuffer
+#endif
+
 // Tabela de nomes curtos das cores (para exibição no display)
 static const char *nome_cores[10] = {
     "pret", // 0 - Preto
@@ -109,26 +198,87 @@ void init_display(ssd1306_t *ssd) {
     gpio_pull_up(I2C_SCL);
 
     // Inicializa e configura o display
-    ssd1306_init(ssd, WIDTH, HEIGHT, false, ADDRESS, I2C_PORT);
+    ssd1306_init_fixo(ssd, false, ADDRESS, I2C_PORT); // Geometria fixa 128x64 com buffer estático
     ssd1306_config(ssd);
     ssd1306_send_data(ssd);
     
     // Limpa o display
-    ssd1306_fill(ssd, false);
+    ssd1306_fill_fixo(false);
     ssd1306_send_data(ssd);
 }
 
-// Inicializa o botão B
+// Inicializa os botões A e B
 void init_button() {
+    gpio_init(BUTTON_A);
+    gpio_set_dir(BUTTON_A, GPIO_IN);
+    gpio_pull_up(BUTTON_A);
+
     gpio_init(BUTTON_B);
     gpio_set_dir(BUTTON_B, GPIO_IN);
     gpio_pull_up(BUTTON_B);
 }
 
+// Reserva memória na arena estática (sem liberação individual)
+void *arena_alloc(size_t tamanho) {
+    size_t inicio = (arena_usado + 3u) & ~(size_t)3u; // Mantém alinhamento de 4 bytes
+    hard_assert(inicio + tamanho <= ARENA_BYTES);
+    arena_usado = inicio + tamanho;
+    return &arena[inicio];
+}
+
+// Inicializa o pino do divisor e o canal DMA da captura em rajada
+void init_capacimetro() {
+    // O divisor fica alimentado em nível alto no modo ohmímetro
+    gpio_init(DIVISOR_PIN);
+    gpio_set_dir(DIVISOR_PIN, GPIO_OUT);
+    gpio_put(DIVISOR_PIN, 1);
+
+    cap_buffer = arena_alloc(CAP_AMOSTRAS * sizeof(uint16_t));
+    cap_iniciar(); // Tabela de log2 do ajuste (fica na SRAM)
+    cap_dma = dma_claim_unused_channel(true);
+}
+
+// Calibra o nível do divisor com as pontas abertas (o ADC vê o próprio GPIO em nível alto)
+void calibrar_topo() {
+    uint32_t soma = 0;
+    uint16_t media;
+    int i;
+
+    adc_select_input(2); // Seleciona o pino 28 como entrada ADC
+    sleep_ms(10);        // Acomodação após ligar o GPIO do divisor
+
+    for(i=0;i<TOPO_AMOSTRAS;i++) {
+        soma += adc_read();
+    }
+    media = (uint16_t)((soma + TOPO_AMOSTRAS / 2) / TOPO_AMOSTRAS);
+
+    // Com um resistor nas pontas mantém o valor atual; ele é corrigido quando as pontas abrirem
+    if(media >= TOPO_MINIMO) {
+        nivel_topo = media;
+    }
+
+    printf("Nivel do divisor: %u\n", nivel_topo); // Debug
+}
+
+#if MEDIR_JITTER
+// Acumula uma medição de tempo (us) na estatística
+__force_inline static void jitter_registrar(Jitter *j, uint32_t dt) {
+    if(dt < j->min) j->min = dt;
+    if(dt > j->max) j->max = dt;
+    j->n++;
+}
+
+// Exibe a estatística (fora das rotinas medidas)
+void jitter_relatorio(const char *nome, Jitter *j) {
+    printf("Jitter %s: %lu us (min: %lu / max: %lu / n: %lu)\n", nome,
+           (unsigned long)(j->max - j->min), (unsigned long)j->min, (unsigned long)j->max, (unsigned long)j->n);
+}
+#endif
+
 // -------- Matriz - Início --------
 
-// Envia a cor de um pixel para o PIO
-static inline void put_pixel(PIO pio, uint sm, uint32_t pixel_grb) {
+// Envia a cor de um pixel para o PIO (sempre inline: é chamada pelo matrix_write na SRAM)
+__force_inline static void put_pixel(PIO pio, uint sm, uint32_t pixel_grb) {
     pio_sm_put_blocking(pio, sm, pixel_grb << 8u);
 }
 
@@ -154,8 +304,8 @@ void matrix_clear_leds() {
     }
 }
 
-// Atualiza os LEDs físicos com as cores do buffer
-void matrix_write(PIO pio, uint sm) {
+// Atualiza os LEDs físicos com as cores do buffer (na SRAM: alimenta o PIO sem depender da flash XIP)
+void FUNC_RAM(matrix_write)(PIO pio, uint sm) {
     for (int i = 0; i < NUM_PIXELS; i++) {
         put_pixel(pio, sm, leds[i]);
     }
@@ -179,13 +329,16 @@ void matrix_init() {
 
 // ---------------- Callback - Início ----------------
 
-// Callback para tratar o botão B (reset para modo BOOTSEL)
+// Callback para tratar os botões A (troca de modo) e B (reset para modo BOOTSEL)
 void gpio_irq_callback(uint gpio, uint32_t events) {
     uint32_t current_time = to_ms_since_boot(get_absolute_time()); // Obtém o tempo atual em ms
 
     // Debounce de 200 ms
     if( (current_time - last_time) > 200 ) {
-        if(gpio == BUTTON_B) {
+        last_time = current_time;
+        if(gpio == BUTTON_A) {
+            modo_capacimetro = !modo_capacimetro;
+        } else if(gpio == BUTTON_B) {
             reset_usb_boot(0, 0);
         }
     }
@@ -197,6 +350,65 @@ void gpio_irq_callback(uint gpio, uint32_t events) {
 
 // ---------------- Funções do ohmímetro - Início ----------------
 
+// Classifica o estado das pontas com poucas leituras rápidas, sem a média completa.
+// Cada limiar é deslocado pela histerese no sentido que mantém o estado anterior
+// Fica na SRAM: adc_read e time_us_32 são inline, então a rajada não busca nada na flash XIP
+EstadoPonta FUNC_RAM(detectar_estado_ponta)(uint16_t *media, EstadoPonta anterior) {
+    int limiar_curto = PONTA_LIMIAR_CURTO;
+    int limiar_fora = nivel_topo - PONTA_MARGEM_FORA;
+    int limiar_aberto = nivel_topo - PONTA_MARGEM_ABERTO;
+    uint32_t soma = 0;
+#if MEDIR_JITTER
+    uint32_t inicio = time_us_32(); // Início da rajada (us)
+#endif
+    int i;
+
+    adc_select_input(2); // Seleciona o pino 28 como entrada ADC
+
+    // Leituras consecutivas, sem espera (~2 us cada)
+    for(i=0;i<PONTA_AMOSTRAS;i++) {
+        soma += adc_read();
+    }
+#if MEDIR_JITTER
+    jitter_registrar(&jitter_amostragem, time_us_32() - inicio);
+#endif
+
+    *media = (uint16_t)((soma + PONTA_AMOSTRAS / 2) / PONTA_AMOSTRAS); // Média arredondada
+
+    // Nenhuma leitura passa do nível do divisor: se passou, a calibração estava baixa
+    if(*media > nivel_topo) nivel_topo = *media;
+
+    limiar_curto += (anterior == PONTA_CURTO) ? PONTA_HISTERESE_CURTO : -PONTA_HISTERESE_CURTO;
+    limiar_fora += (anterior == PONTA_FORA_FAIXA || anterior == PONTA_ABERTA) ? -PONTA_HISTERESE : PONTA_HISTERESE;
+    limiar_aberto += (anterior == PONTA_ABERTA) ? -PONTA_HISTERESE : PONTA_HISTERESE;
+
+    if(*media < limiar_curto) return PONTA_CURTO;
+    if(*media >= limiar_aberto) return PONTA_ABERTA;
+    if(*media >= limiar_fora) return PONTA_FORA_FAIXA;
+    return PONTA_NA_FAIXA;
+}
+
+// Aguarda até o estado das pontas se estabilizar e retorna o estado confirmado
+EstadoPonta aguardar_estado_ponta(uint16_t *media, EstadoPonta anterior) {
+    EstadoPonta estado = detectar_estado_ponta(media, anterior);
+    EstadoPonta novo;
+    int iguais = 1;
+
+    // Exige algumas classificações iguais seguidas (filtra o mau contato da inserção)
+    while(iguais < PONTA_CONFIRMACOES) {
+        sleep_ms(PONTA_INTERVALO_MS);
+        novo = detectar_estado_ponta(media, anterior);
+        if(novo == estado) {
+            iguais++;
+        } else {
+            estado = novo;
+            iguais = 1;
+        }
+    }
+
+    return estado;
+}
+
 // Lê a resistência desconhecida via ADC
 int ler_resistor(float *r_x, float *tensao) {
     float soma = 0.0f;
@@ -210,12 +422,105 @@ int ler_resistor(float *r_x, float *tensao) {
         sleep_ms(1);
     }
 
+    // Tensão no nó do ADC (referenciada ao VREF) e resistência pela razão em relação ao nível do divisor
     *tensao = ( ( ( soma/1000.f ) * ADC_VREF ) / (float)ADC_RESOLUTION );
-    *r_x = ( ( *tensao * (float)R_CONHECIDO ) / (ADC_VREF - *tensao) );
+    *r_x = ( ( ( soma/1000.f ) * (float)R_CONHECIDO ) / ( (float)nivel_topo - ( soma/1000.f ) ) );
 
     return 0;
 }
 
+// Captura a curva de carga do capacitor em rajada via DMA (clkdiv 0 = 500 ksps)
+void capturar_carga(float clkdiv) {
+    uint32_t inicio;
+
+    adc_select_input(2); // Seleciona o pino 28 como entrada ADC
+
+    // Descarrega o capacitor pelo R_CONHECIDO
+    gpio_put(DIVISOR_PIN, 0);
+    inicio = to_ms_since_boot(get_absolute_time());
+    while(adc_read() > CAP_LIMIAR_DESCARGA && (to_ms_since_boot(get_absolute_time()) - inicio) < CAP_DESCARGA_MS) {
+        sleep_ms(1);
+    }
+
+    // Configura a FIFO do ADC para gerar DREQ a cada amostra
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv(clkdiv);
+
+    dma_channel_config cfg = dma_channel_get_default_config(cap_dma);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_dreq(&cfg, DREQ_ADC);
+    dma_channel_configure(cap_dma, &cfg, cap_buffer, &adc_hw->fifo, CAP_AMOSTRAS, true);
+
+    // Aplica o degrau e inicia a conversão contínua
+    gpio_put(DIVISOR_PIN, 1);
+    adc_run(true);
+
+    dma_channel_wait_for_finish_blocking(cap_dma);
+
+    // Volta o ADC ao modo de leitura única
+    adc_run(false);
+    adc_fifo_drain();
+    adc_fifo_setup(false, false, 0, false, false);
+    adc_set_clkdiv(0);
+}
+
+// Lê o platô da curva de carga (nível alto do GPIO visto pelo ADC) após a acomodação.
+// Se a curva chegou a 90% dentro da janela, tau <= janela/2.3 e, após mais 3 janelas, o erro é < 0.01%
+uint16_t ler_plato(float janela_us) {
+    uint32_t soma = 0;
+    int i;
+
+    sleep_us((uint64_t)(janela_us * CAP_PLATO_JANELAS));
+
+    for(i=0;i<CAP_PLATO_AMOSTRAS;i++) {
+        soma += adc_read();
+    }
+
+    return (uint16_t)((soma + CAP_PLATO_AMOSTRAS / 2) / CAP_PLATO_AMOSTRAS);
+}
+
+// Mede a capacitância, reduzindo a taxa de amostragem até a curva caber na janela
+cap_resultado_t ler_capacitor(float *c_x, float *tau_us) {
+    cap_resultado_t resultado = CAP_SEM_SINAL;
+    float periodo_us = CAP_PERIODO_US;
+    float clkdiv = 0.0f;
+    float tau;
+    uint16_t v_final;
+    int escala;
+
+    for(escala=0;escala<CAP_ESCALAS;escala++) {
+        capturar_carga(clkdiv);
+
+        // O platô real depende da alimentação do GPIO, não do fundo de escala do ADC.
+        // Se a curva ainda está claramente subindo (ou em curto), o ajuste vai recusá-la de
+        // qualquer forma: usa o nível conhecido do divisor e dispensa a espera de 3 janelas
+        if(cap_buffer[CAP_AMOSTRAS - 1] < ((uint32_t)nivel_topo * CAP_SUBINDO_PCT) / 100) {
+            v_final = nivel_topo;
+        } else {
+            v_final = ler_plato(periodo_us * CAP_AMOSTRAS);
+        }
+        resultado = cap_ajustar_tau(cap_buffer, CAP_AMOSTRAS, v_final, &tau);
+
+        // Platô acomodado sem carga DC: é o próprio nível do divisor, usado também pelo ohmímetro
+        if(resultado == CAP_OK) nivel_topo = v_final;
+
+        if(resultado != CAP_LENTO) break;
+
+        // Curva lenta: amostra 10x mais devagar (clkdiv conta ciclos de 48 MHz por amostra)
+        periodo_us *= 10.0f;
+        clkdiv = (periodo_us * 48.0f) - 1.0f;
+    }
+
+    if(resultado == CAP_OK) {
+        *tau_us = tau * periodo_us;
+        *c_x = ( *tau_us * 1000.0f ) / (float)R_CONHECIDO; // tau = R*C -> C em nF
+    }
+
+    return resultado;
+}
+
 // Encontra o resistor da série E24 mais próximo do valor lido pelo ADC
 float resistor_e24(float resistencia_medida) {
     // Valores básicos da série E24
@@ -326,16 +631,16 @@ void obter_cores_resistor(float resistencia, char seg1[5], char seg2[5], char se
 }
 
 // Desenha representação gráfica do resistor no OLED e na matriz de LEDs
-void draw_resistors(ssd1306_t *ssd) {
-    ssd1306_rect(ssd, 25, 11, 106, 10, true, false);
-    ssd1306_hline(ssd,3,10,30,true);
-    ssd1306_hline(ssd,117,124,30,true);
-    ssd1306_vline(ssd,24,26,33,true);
-    ssd1306_vline(ssd,25,26,33,true);
-    ssd1306_vline(ssd,63,26,33,true);
-    ssd1306_vline(ssd,64,26,33,true);
-    ssd1306_vline(ssd,102,26,33,true);
-    ssd1306_vline(ssd,103,26,33,true);
+void draw_resistors() {
+    ssd1306_rect_fixo(25, 11, 106, 10, true, false);
+    ssd1306_hline_fixo(3,10,30,true);
+    ssd1306_hline_fixo(117,124,30,true);
+    ssd1306_vline_fixo(24,26,33,true);
+    ssd1306_vline_fixo(25,26,33,true);
+    ssd1306_vline_fixo(63,26,33,true);
+    ssd1306_vline_fixo(64,26,33,true);
+    ssd1306_vline_fixo(102,26,33,true);
+    ssd1306_vline_fixo(103,26,33,true);
     matrix_set_led(6,1,1,1);
     matrix_set_led(7,1,1,1);
     matrix_set_led(8,1,1,1);
@@ -346,10 +651,132 @@ void draw_resistors(ssd1306_t *ssd) {
     matrix_set_led(18,1,1,1);
 }
 
+// Exibe no OLED e na matriz o estado das pontas quando não há resistor mensurável
+void mostrar_estado_ponta(ssd1306_t *ssd, EstadoPonta estado, uint16_t media) {
+    char volt[6]; // Buffer para armazenar a tensão formatada como string
+
+    snprintf(volt, sizeof(volt), "%05.3f", ( (float)media * ADC_VREF ) / (float)ADC_RESOLUTION);
+
+    // Debug
+    printf("Estado: %s / tensao: %s\n", nome_estados[estado], volt);
+
+    // Apaga as faixas de cores e mostra o estado no lugar da resistência
+    ssd1306_draw_string_fixo("    ",10,4);
+    ssd1306_draw_string_fixo("    ",49,4);
+    ssd1306_draw_string_fixo("    ",88,4);
+    ssd1306_draw_string_fixo("    ",10,13);
+    ssd1306_draw_string_fixo("    ",49,13);
+    ssd1306_draw_string_fixo("    ",88,13);
+    ssd1306_draw_string_fixo(nome_estados[estado],8,53);
+    ssd1306_draw_string_fixo(volt,76,53);
+    ssd1306_send_data(ssd);
+
+    // Apaga as faixas do resistor na matriz (LEDs 13, 12 e 11)
+    matrix_set_led(13,0,0,0);
+    matrix_set_led(12,0,0,0);
+    matrix_set_led(11,0,0,0);
+    matrix_write(pio,sm);
+}
+
+// Desenha os rótulos do modo atual no OLED
+void draw_rotulos() {
+    if(modo_capacimetro) {
+        ssd1306_draw_string_fixo("cap:",18,43);
+        ssd1306_draw_string_fixo("tau: ",77,43);
+    } else {
+        ssd1306_draw_string_fixo("res:",18,43);
+        ssd1306_draw_string_fixo("volt:",77,43);
+    }
+}
+
+// Mede e exibe a capacitância no OLED
+void mostrar_capacitor(ssd1306_t *ssd) {
+    float c_x;    // Capacitância medida (nF)
+    float tau_us; // Constante de tempo medida (us)
+    char cap[7];  // Buffer para armazenar a capacitância formatada como string
+    char tau[6];  // Buffer para armazenar a constante de tempo formatada como string
+    cap_resultado_t resultado = ler_capacitor(&c_x, &tau_us);
+
+    if(resultado == CAP_OK) {
+        // Capacitância em nF ("n") ou uF ("u")
+        if(c_x < 1000.0f) snprintf(cap, sizeof(cap), "%5.1fn", c_x);
+        else snprintf(cap, sizeof(cap), "%5.2fu", c_x / 1000.0f);
+        // Constante de tempo em us ("u") ou ms ("m"), sempre com 5 caracteres
+        if(tau_us < 9999.5f) snprintf(tau, sizeof(tau), "%4.0fu", tau_us);
+        else if(tau_us < 99950.0f) snprintf(tau, sizeof(tau), "%4.1fm", tau_us / 1000.0f);
+        else snprintf(tau, sizeof(tau), "%4.0fm", tau_us / 1000.0f);
+    } else {
+        // Curva rápida demais: abaixo da faixa (~0.7 nF), o que inclui as pontas abertas
+        snprintf(cap, sizeof(cap), "%s", resultado == CAP_SEM_SINAL ? "curto " :
+                                          resultado == CAP_LENTO ? "fora  " : "baixo ");
+        snprintf(tau, sizeof(tau), "     ");
+    }
+
+    // Debug
+    printf("cap: %s / tau: %s / resultado: %d\n", cap, tau, resultado);
+
+    // Apaga as faixas de cores (não se aplicam ao capacitor)
+    ssd1306_draw_string_fixo("    ",10,4);
+    ssd1306_draw_string_fixo("    ",49,4);
+    ssd1306_draw_string_fixo("    ",88,4);
+    ssd1306_draw_string_fixo("    ",10,13);
+    ssd1306_draw_string_fixo("    ",49,13);
+    ssd1306_draw_string_fixo("    ",88,13);
+    ssd1306_draw_string_fixo(cap,8,53);
+    ssd1306_draw_string_fixo(tau,76,53);
+    ssd1306_send_data(ssd);
+
+    matrix_set_led(13,0,0,0);
+    matrix_set_led(12,0,0,0);
+    matrix_set_led(11,0,0,0);
+    matrix_write(pio,sm);
+}
+
 // ---------------- Funções do ohmímetro - Fim ----------------
 
 
 
+#if BENCH_DISPLAY
+// Mede no alvo o desenho de um quadro com o driver genérico e com a variante de geometria fixa,
+// ambos executando da flash (FUNCOES_NA_RAM 0) para que só o algoritmo seja comparado
+void benchmark_display() {
+    ssd1306_t gen;   // Display genérico (só o buffer é usado, nada é enviado)
+    uint32_t inicio; // Instante de início de cada medição (us)
+    uint32_t t_gen, t_fixo;
+    int i;
+
+    ssd1306_init(&gen, WIDTH, HEIGHT, false, ADDRESS, I2C_PORT);
+
+    // Aguarda o terminal USB para não perder o resultado
+    while(!stdio_usb_connected()) sleep_ms(100);
+
+    inicio = time_us_32();
+    for(i=0;i<BENCH_REPETICOES;i++) {
+        ssd1306_draw_string(&gen,"000123",8,53);
+        ssd1306_draw_string(&gen,"3.123",76,53);
+        ssd1306_draw_string(&gen,"marr",10,4);
+    }
+    t_gen = time_us_32() - inicio;
+
+    inicio = time_us_32();
+    for(i=0;i<BENCH_REPETICOES;i++) {
+        ssd1306_draw_string_fixo("000123",8,53);
+        ssd1306_draw_string_fixo("3.123",76,53);
+        ssd1306_draw_string_fixo("marr",10,4);
+    }
+    t_fixo = time_us_32() - inicio;
+
+    printf("Desenho de quadro: generico %lu ns / fixo %lu ns\n",
+           (unsigned long)((uint64_t)t_gen * 1000 / BENCH_REPETICOES),
+           (unsigned long)((uint64_t)t_fixo * 1000 / BENCH_REPETICOES));
+
+    free(gen.ram_buffer);
+    ssd1306_fill_fixo(false); // Descarta o que foi desenhado no framebuffer real
+}
+#endif
+
+
+
 int main() {
     float r_x;     // Armazena o valor da resistência desconhecida lida
     float tensao;  // Armazena o valor da tensão lida pelo ADC
@@ -359,7 +786,21 @@ int main() {
     char seg1[5];  // Buffer para a primeira faixa de cor do resistor
     char seg2[5];  // Buffer para a segunda faixa de cor do resistor
     char seg3[5];  // Buffer para a terceira faixa de cor do resistor
+    char e24_1[5]; // Buffers para as faixas de cor do resistor E24
+    char e24_2[5];
+    char e24_3[5];
     ssd1306_t ssd; // Estrutura que representa o display OLED
+    uint16_t media_ponta; // Média rápida do ADC usada na detecção das pontas
+    EstadoPonta estado;   // Estado atual das pontas
+    EstadoPonta estado_anterior = PONTA_ABERTA; // Último estado exibido
+    bool medir = true;    // Indica que uma nova leitura completa deve ser feita
+    uint16_t media_medida = 0; // Média rápida no momento da última leitura completa
+    uint16_t media_leitura;    // Média da leitura completa, em contagens do ADC
+    uint32_t t_leitura = 0;    // Instante da última leitura completa (ms)
+    bool modo_anterior = false; // Último modo exibido (false = ohmímetro)
+#if MEDIR_JITTER
+    uint32_t t_desenho;   // Instante de início do desenho do quadro (us)
+#endif
 
     stdio_init_all(); // Inicializa as entradas e saídas padrões
 
@@ -367,21 +808,24 @@ int main() {
 
     init_display(&ssd); // Inicializa o display OLED
 
+#if BENCH_DISPLAY
+    benchmark_display(); // Compara o desenho genérico x fixo no alvo
+#endif
+
     // Desenha a borda do display
-    ssd1306_rect(&ssd, 0, 0, 128, 64, true, false);
+    ssd1306_rect_fixo(0, 0, 128, 64, true, false);
 
     // Desenha os rótulos "res:" e "volt:" no display
-    ssd1306_draw_string(&ssd,"res:",18,43);
-    ssd1306_draw_string(&ssd,"volt:",77,43);
+    draw_rotulos();
 
     // Desenha linhas verticais e horizontais para separar as áreas do display
-    ssd1306_vline(&ssd,63,41,62,true);
-    ssd1306_vline(&ssd,64,41,62,true);
-    ssd1306_hline(&ssd,1,126,40,true);
-    ssd1306_hline(&ssd,1,126,39,true);
+    ssd1306_vline_fixo(63,41,62,true);
+    ssd1306_vline_fixo(64,41,62,true);
+    ssd1306_hline_fixo(1,126,40,true);
+    ssd1306_hline_fixo(1,126,39,true);
 
     // Desenha a representação do resistor no display e na matriz de LEDs
-    draw_resistors(&ssd);
+    draw_resistors();
 
     ssd1306_send_data(&ssd); // Envia os dados para escrever no display
     matrix_write(pio, sm);   // Envia os dados para escrever na matriz
@@ -389,20 +833,86 @@ int main() {
     adc_init();             // Inicializa o ADC
     adc_gpio_init(ADC_PIN); // Inicializa o pino 28 como entrada analógica
 
+    init_capacimetro(); // Inicializa o pino do divisor e a captura em rajada
+
+    calibrar_topo(); // Mede o nível do divisor (ligar com as pontas abertas)
+
     init_button(); // Inicializa o botão B
 
     gpio_set_irq_enabled_with_callback(BUTTON_B, GPIO_IRQ_EDGE_FALL, true, &gpio_irq_callback); // Configura a interrupção para o botão B
+    gpio_set_irq_enabled(BUTTON_A, GPIO_IRQ_EDGE_FALL, true); // Configura a interrupção para o botão A (mesmo callback)
 
     while (true) {
 
+        // Troca de modo: redesenha os rótulos e força uma nova leitura
+        if(modo_capacimetro != modo_anterior) {
+            modo_anterior = modo_capacimetro;
+            draw_rotulos();
+            medir = true;
+        }
+
+        // Modo capacímetro: a detecção DC das pontas não se aplica (capacitor parece aberto)
+        if(modo_capacimetro) {
+            mostrar_capacitor(&ssd);
+            sleep_ms(500);
+            continue;
+        }
+
+        estado = aguardar_estado_ponta(&media_ponta, estado_anterior); // Classifica as pontas antes da leitura completa
+
+        // Uma mudança de estado (ex.: inserção de um novo resistor) dispara uma nova leitura
+        if(estado != estado_anterior) {
+            medir = true;
+        }
+        estado_anterior = estado;
+
+        // Sem resistor mensurável: mostra o estado e pula a média completa
+        if(estado != PONTA_NA_FAIXA) {
+            if(medir) {
+                mostrar_estado_ponta(&ssd, estado, media_ponta);
+                medir = false;
+            }
+            continue;
+        }
+
+        // Resistor trocado sem pontas abertas confirmadas, valor variando (ex.: potenciômetro)
+        // ou leitura antiga: refaz a leitura completa
+        if(abs((int)media_ponta - (int)media_medida) > PONTA_VARIACAO ||
+           (to_ms_since_boot(get_absolute_time()) - t_leitura) >= PONTA_RELEITURA_MS) {
+            medir = true;
+        }
+
+        // Mesmo resistor ainda conectado e estável: nada a refazer
+        if(!medir) {
+            continue;
+        }
+        medir = false;
+
         ler_resistor(&r_x,&tensao); // Calcula a tensão no divisor e o valor do resistor desconhecido
 
+        // Descarta a leitura se o resistor foi removido durante a média
+        if(detectar_estado_ponta(&media_ponta, PONTA_NA_FAIXA) != PONTA_NA_FAIXA) {
+            medir = true;
+            continue;
+        }
+
+        // Descarta a leitura se o valor mudou durante a média (contato ainda acomodando)
+        media_leitura = (uint16_t)( ( tensao * (float)ADC_RESOLUTION ) / ADC_VREF + 0.5f );
+        if(abs((int)media_ponta - (int)media_leitura) > PONTA_VARIACAO) {
+            medir = true;
+            continue;
+        }
+        media_medida = media_ponta;
+        t_leitura = to_ms_since_boot(get_absolute_time());
+
         r_e24 = resistor_e24(r_x); // Calcula o resistor mais próximo da série E24
 
         printf("r_x: %f/ tensao: %f/ r_e24: %f\n ",r_x,tensao,r_e24); // Debug no terminal
 
         mostrar_resistor_matriz(r_e24); // Mostra as cores do resistor E24 na matriz de LEDs
 
+        if(r_x > R_MAXIMO) r_x = R_MAXIMO; // A média completa pode passar um pouco do limiar rápido
+
         snprintf(res, sizeof(res), "%06d", (int)(r_x+0.5f)); // Formata a resistência como string e coloca no buffer
         snprintf(volt, sizeof(volt), "%05.3f", tensao);      // Formata a tensão como string e coloca no buffer
         
@@ -410,21 +920,33 @@ int main() {
         printf("%s\n",res);
         printf("%s\n",volt);
 
-        ssd1306_draw_string(&ssd,res,8,53);   // Escreve no display OLED o valor da resistência calculada
-        ssd1306_draw_string(&ssd,volt,76,53); // Escreve no display OLED o valor da tensão calculada
-
-        // Obtém as cores das faixas do resistor lido (r_x) e escreve no display
+        // Obtém as cores das faixas do resistor lido (r_x) e do resistor E24 mais próximo
         obter_cores_resistor(r_x, seg1, seg2, seg3);
-        ssd1306_draw_string(&ssd,seg1,10,4);
-        ssd1306_draw_string(&ssd,seg2,49,4);
-        ssd1306_draw_string(&ssd,seg3,88,4);
-
-        // Obtém as cores das faixas para o resistor E24 mais próximo e escreve no display
-        obter_cores_resistor(r_e24, seg1, seg2, seg3);
-        ssd1306_draw_string(&ssd,seg1,10,13);
-        ssd1306_draw_string(&ssd,seg2,49,13);
-        ssd1306_draw_string(&ssd,seg3,88,13);
-        
+        obter_cores_resistor(r_e24, e24_1, e24_2, e24_3);
+
+#if MEDIR_JITTER
+        t_desenho = time_us_32();
+#endif
+        ssd1306_draw_string_fixo(res,8,53);   // Escreve no display OLED o valor da resistência calculada
+        ssd1306_draw_string_fixo(volt,76,53); // Escreve no display OLED o valor da tensão calculada
+
+        // Escreve no display as faixas do resistor lido e as do resistor E24
+        ssd1306_draw_string_fixo(seg1,10,4);
+        ssd1306_draw_string_fixo(seg2,49,4);
+        ssd1306_draw_string_fixo(seg3,88,4);
+        ssd1306_draw_string_fixo(e24_1,10,13);
+        ssd1306_draw_string_fixo(e24_2,49,13);
+        ssd1306_draw_string_fixo(e24_3,88,13);
+#if MEDIR_JITTER
+        jitter_registrar(&jitter_desenho, time_us_32() - t_desenho);
+
+        // Relatório único após JITTER_QUADROS quadros (debug)
+        if(jitter_desenho.n == JITTER_QUADROS) {
+            jitter_relatorio("amostragem", &jitter_amostragem);
+            jitter_relatorio("desenho", &jitter_desenho);
+        }
+#endif
+
         ssd1306_send_data(&ssd); // Envia os dados para escrever no display
     }
 }
\ No newline at end of file
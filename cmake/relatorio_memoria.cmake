@@ -0,0 +1,119 @@
+# Gera o orçamento de memória (seções e símbolos) a partir do ELF
+# Uso: cmake -DNM=<nm> -DOBJDUMP=<objdump> -DELF=<arquivo.elf> -DSAIDA=<relatorio.txt> -P relatorio_memoria.cmake
+
+# Mapa de memória do RP2040 (Pico W: 2 MB de flash, 264 KB de SRAM)
+set(FLASH_INICIO 268435456) # 0x10000000 (XIP)
+set(FLASH_TAMANHO 2097152)  # 2 MB
+set(RAM_INICIO 536870912)   # 0x20000000 (SRAM)
+set(RAM_TAMANHO 270336)     # 264 KB (SRAM0-5, incluindo SCRATCH_X/Y)
+math(EXPR FLASH_FIM "${FLASH_INICIO} + ${FLASH_TAMANHO}")
+math(EXPR RAM_FIM "${RAM_INICIO} + ${RAM_TAMANHO}")
+
+# Formata "usado / capacidade (xx.x%)"
+function(formatar_uso USADO CAPACIDADE SAIDA_VAR)
+    math(EXPR PERMIL "${USADO} * 1000 / ${CAPACIDADE}")
+    math(EXPR INTEIRO "${PERMIL} / 10")
+    math(EXPR DECIMAL "${PERMIL} % 10")
+    set(${SAIDA_VAR} "${USADO} / ${CAPACIDADE} bytes (${INTEIRO}.${DECIMAL}%)" PARENT_SCOPE)
+endfunction()
+
+# ---- Seções: flash pelo endereço de carga (LMA), RAM pelo endereço de execução (VMA) ----
+# Assim .data e as funções __not_in_flash_func contam nas duas: imagem na flash, cópia na SRAM
+
+execute_process(
+        COMMAND ${OBJDUMP} -h ${ELF}
+        OUTPUT_VARIABLE SECOES
+        RESULT_VARIABLE RESULTADO
+        )
+if(NOT RESULTADO EQUAL 0)
+    message(FATAL_ERROR "Falha ao executar ${OBJDUMP} em ${ELF}")
+endif()
+
+set(USO_FLASH 0)
+set(USO_RAM 0)
+set(LINHAS_SECOES "")
+set(NOME_SECAO "")
+
+string(REPLACE "\n" ";" SECOES "${SECOES}")
+foreach(LINHA IN LISTS SECOES)
+    # Linha da seção: índice, nome, tamanho, VMA, LMA, offset, alinhamento
+    if(LINHA MATCHES "^ *[0-9]+ +([^ ]+) +([0-9a-f]+) +([0-9a-f]+) +([0-9a-f]+) +[0-9a-f]+ +2\\*\\*[0-9]+$")
+        set(NOME_SECAO "${CMAKE_MATCH_1}")
+        math(EXPR TAMANHO "0x${CMAKE_MATCH_2}")
+        math(EXPR VMA "0x${CMAKE_MATCH_3}")
+        math(EXPR LMA "0x${CMAKE_MATCH_4}")
+        continue()
+    endif()
+
+    # Linha seguinte: atributos da seção
+    if(NOME_SECAO STREQUAL "" OR TAMANHO EQUAL 0)
+        set(NOME_SECAO "")
+        continue()
+    endif()
+
+    set(REGIOES "")
+    if(LINHA MATCHES "LOAD" AND LMA GREATER_EQUAL FLASH_INICIO AND LMA LESS FLASH_FIM)
+        math(EXPR USO_FLASH "${USO_FLASH} + ${TAMANHO}")
+        string(APPEND REGIOES "flash ")
+    endif()
+    if(LINHA MATCHES "ALLOC" AND VMA GREATER_EQUAL RAM_INICIO AND VMA LESS RAM_FIM)
+        math(EXPR USO_RAM "${USO_RAM} + ${TAMANHO}")
+        string(APPEND REGIOES "ram")
+    endif()
+    string(STRIP "${REGIOES}" REGIOES)
+    if(NOT REGIOES STREQUAL "")
+        string(APPEND LINHAS_SECOES "${TAMANHO}\t${REGIOES}\t${NOME_SECAO}\n")
+    endif()
+    set(NOME_SECAO "")
+endforeach()
+
+# ---- Símbolos, pela região em que residem/executam ----
+
+execute_process(
+        COMMAND ${NM} --print-size --size-sort --reverse-sort --radix=x ${ELF}
+        OUTPUT_VARIABLE SIMBOLOS
+        RESULT_VARIABLE RESULTADO
+        )
+if(NOT RESULTADO EQUAL 0)
+    message(FATAL_ERROR "Falha ao executar ${NM} em ${ELF}")
+endif()
+
+set(LINHAS_FLASH "")
+set(LINHAS_RAM "")
+
+string(REPLACE "\n" ";" SIMBOLOS "${SIMBOLOS}")
+foreach(LINHA IN LISTS SIMBOLOS)
+    if(NOT LINHA MATCHES "^([0-9a-f]+) ([0-9a-f]+) ([A-Za-z]) (.+)$")
+        continue()
+    endif()
+
+    # Converte endereço e tamanho de hexadecimal para decimal
+    math(EXPR ENDERECO "0x${CMAKE_MATCH_1}")
+    math(EXPR TAMANHO "0x${CMAKE_MATCH_2}")
+    set(TIPO "${CMAKE_MATCH_3}")
+    set(NOME "${CMAKE_MATCH_4}")
+
+    if(ENDERECO GREATER_EQUAL RAM_INICIO AND ENDERECO LESS RAM_FIM)
+        string(APPEND LINHAS_RAM "${TAMANHO}\t${TIPO}\t${NOME}\n")
+    elseif(ENDERECO GREATER_EQUAL FLASH_INICIO AND ENDERECO LESS FLASH_FIM)
+        string(APPEND LINHAS_FLASH "${TAMANHO}\t${TIPO}\t${NOME}\n")
+    endif()
+endforeach()
+
+formatar_uso(${USO_RAM} ${RAM_TAMANHO} TEXTO_RAM)
+formatar_uso(${USO_FLASH} ${FLASH_TAMANHO} TEXTO_FLASH)
+
+file(WRITE ${SAIDA}
+        "Orçamento de memória: ${ELF}\n\n"
+        "RAM:   ${TEXTO_RAM}\n"
+        "Flash: ${TEXTO_FLASH}\n\n"
+        "---- Seções (bytes, região, seção) ----\n${LINHAS_SECOES}\n"
+        "---- Símbolos na RAM (bytes, tipo, símbolo) ----\n${LINHAS_RAM}\n"
+        "---- Símbolos na flash (bytes, tipo, símbolo) ----\n${LINHAS_FLASH}"
+        )
+
+message(STATUS "Memória: RAM ${TEXTO_RAM} / flash ${TEXTO_FLASH} (detalhes em ${SAIDA})")
+
+if(USO_RAM GREATER RAM_TAMANHO OR USO_FLASH GREATER FLASH_TAMANHO)
+    message(FATAL_ERROR "Orçamento de memória excedido")
+endif()
@@ -0,0 +1,81 @@
+#include <math.h>
+#include "capacimetro.h"
+#include "func_ram.h"
+
+#define LOG2_BITS 6                   // Bits da mantissa indexados na tabela (64 intervalos)
+#define LOG2_RESTO (16 - LOG2_BITS)   // Bits restantes, usados na interpolação
+#define LN2 0.69314718055994530942    // ln(2), para converter a inclinação de log2 para ln
+
+// log2(1 + i/64) em Q16; não é const para ficar na SRAM junto com o ajuste
+static uint32_t tabela_log2[(1 << LOG2_BITS) + 1];
+
+void cap_iniciar(void) {
+  for (int i = 0; i <= (1 << LOG2_BITS); ++i)
+    tabela_log2[i] = (uint32_t)(log2(1.0 + (double)i / (1 << LOG2_BITS)) * 65536.0 + 0.5);
+}
+
+// log2(d) em Q16 para 1 <= d <= 4095, só com operações inteiras de 32 bits
+static uint32_t FUNC_RAM(log2_q16)(uint32_t d) {
+  uint32_t expoente = 0;
+  uint32_t frac, idx, resto;
+
+  while ((d >> (expoente + 1)) != 0)
+    expoente++;
+
+  frac = ((d << 16) >> expoente) - 65536; // Mantissa em Q16, no intervalo [0, 1)
+  idx = frac >> LOG2_RESTO;
+  resto = frac & ((1u << LOG2_RESTO) - 1);
+
+  return (expoente << 16) + tabela_log2[idx] +
+         (((tabela_log2[idx + 1] - tabela_log2[idx]) * resto) >> LOG2_RESTO);
+}
+
+cap_resultado_t FUNC_RAM(cap_ajustar_tau)(const uint16_t *amostras, size_t n, uint16_t v_final, float *tau) {
+  // Faixa usada no ajuste: de 10% a 90% do valor final
+  uint16_t v_min = v_final / 10;
+  uint16_t v_max = v_final - v_final / 10;
+
+  // Somas do ajuste por mínimos quadrados: x é o índice da amostra, y = log2(v_final - v) em Q16.
+  // Por amostra só há multiplicações de 32 bits (x * y < 4096 * 12 * 2^16) e somas de 64 bits
+  uint64_t soma_x = 0, soma_xx = 0, soma_y = 0, soma_xy = 0;
+  uint32_t y, x;
+  int64_t pontos = 0;
+  double num, den;
+
+  if (n > CAP_MAX_AMOSTRAS)
+    n = CAP_MAX_AMOSTRAS;
+
+  if (n == 0 || v_final < CAP_PLATO_MINIMO || amostras[n - 1] < v_min)
+    return CAP_SEM_SINAL;
+  if (amostras[n - 1] < v_max)
+    return CAP_LENTO;
+
+  for (x = 0; x < n; ++x) {
+    if (amostras[x] < v_min)
+      continue;
+    if (amostras[x] > v_max)
+      break; // O restante da curva está saturado e só acrescenta ruído
+    y = log2_q16(v_final - amostras[x]);
+    soma_x += x;
+    soma_xx += x * x;
+    soma_y += y;
+    soma_xy += x * y;
+    pontos++;
+  }
+
+  if (pontos < CAP_MIN_PONTOS)
+    return CAP_RAPIDO;
+
+  // Combinação final, uma vez por ajuste
+  den = (double)(pontos * (int64_t)soma_xx - (int64_t)(soma_x * soma_x));
+  if (den <= 0.0)
+    return CAP_RAPIDO;
+
+  num = (double)(pontos * (int64_t)soma_xy - (int64_t)(soma_x * soma_y));
+  if (num >= 0.0)
+    return CAP_LENTO;
+
+  // Inclinação em log2 Q16 por amostra -> tau = -1 / inclinação em ln
+  *tau = (float)(-65536.0 * den / (num * LN2));
+  return CAP_OK;
+}
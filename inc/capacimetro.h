@@ -0,0 +1,27 @@
+#ifndef CAPACIMETRO_H
+#define CAPACIMETRO_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Resultado do ajuste da curva de carga RC
+typedef enum {
+  CAP_OK,       // Constante de tempo ajustada
+  CAP_RAPIDO,   // Curva subiu rápido demais para a taxa de amostragem
+  CAP_LENTO,    // Curva não chegou a 90% dentro da janela de captura
+  CAP_SEM_SINAL // Curva não saiu do zero (pontas em curto)
+} cap_resultado_t;
+
+#define CAP_MIN_PONTOS 8    // Mínimo de amostras entre 10% e 90% para aceitar o ajuste
+#define CAP_PLATO_MINIMO 64 // Platô abaixo disso indica pontas em curto
+#define CAP_MAX_AMOSTRAS 4096 // Maior curva aceita (as somas do ajuste usam 32 bits por amostra)
+
+// Preenche a tabela de log2 usada no ajuste (chamar uma vez antes de cap_ajustar_tau)
+void cap_iniciar(void);
+
+// Ajusta a exponencial v(t) = v_final * (1 - e^(-t/tau)) pelo método log-linear.
+// Não depende do hardware, então pode ser compilado e testado no host.
+// v_final é o platô medido após a acomodação da curva; tau é retornado em períodos de amostragem.
+cap_resultado_t cap_ajustar_tau(const uint16_t *amostras, size_t n, uint16_t v_final, float *tau);
+
+#endif
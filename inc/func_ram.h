@@ -0,0 +1,17 @@
+#ifndef FUNC_RAM_H
+#define FUNC_RAM_H
+
+// Rotinas dos caminhos críticos executam da SRAM por padrão; com FUNCOES_NA_RAM 0
+// tudo fica na flash (XIP), para comparar as duas colocações a partir da mesma árvore
+#ifndef FUNCOES_NA_RAM
+#define FUNCOES_NA_RAM 1
+#endif
+
+#if FUNCOES_NA_RAM && __has_include("pico.h")
+#include "pico.h" // __not_in_flash_func
+#define FUNC_RAM(func_name) __not_in_flash_func(func_name)
+#else
+#define FUNC_RAM(func_name) func_name // Flash ou compilação no host
+#endif
+
+#endif
@@ -1,5 +1,7 @@
 #include "ssd1306.h"
 #include "font.h"
+#include "func_ram.h"
+#include <string.h>
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
   ssd->width = width;
@@ -153,11 +155,10 @@ void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value
     ssd1306_pixel(ssd, x, y, value);
 }
 
-// Função para desenhar um caractere
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+// Retorna o índice do caractere na fonte
+static uint16_t FUNC_RAM(ssd1306_font_index)(char c)
 {
   uint16_t index = 0;
-  char ver=c;
   if (c >= 'a' && c <= 'z')
   {
     index = (c - 'a' + 37) * 8; // Para letras minúsculas
@@ -174,6 +175,13 @@ void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
   {
     index = 68 * 8;
   }
+  return index;
+}
+
+// Função para desenhar um caractere
+void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+{
+  uint16_t index = ssd1306_font_index(c);
   
   for (uint8_t i = 0; i < 8; ++i)
   {
@@ -202,4 +210,95 @@ void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
       break;
     }
   }
-}
\ No newline at end of file
+}
+
+
+// ---- Variante com geometria fixa ----
+// As rotinas de desenho ficam na SRAM (a fonte e o buffer já estão na RAM); fill e init rodam só na inicialização
+
+uint8_t ssd1306_fixo_buffer[SSD1306_FIXO_BUFSIZE] __attribute__((aligned(4)));
+
+void ssd1306_init_fixo(ssd1306_t *ssd, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+  ssd->width = WIDTH;
+  ssd->height = HEIGHT;
+  ssd->pages = SSD1306_FIXO_PAGES;
+  ssd->address = address;
+  ssd->i2c_port = i2c;
+  ssd->external_vcc = external_vcc;
+  ssd->bufsize = SSD1306_FIXO_BUFSIZE;
+  ssd->ram_buffer = ssd1306_fixo_buffer; // Sem calloc: buffer estático
+  ssd->ram_buffer[0] = 0x40;
+  ssd->port_buffer[0] = 0x80;
+}
+
+void ssd1306_fill_fixo(bool value) {
+  memset(&ssd1306_fixo_buffer[1], value ? 0xFF : 0x00, SSD1306_FIXO_BUFSIZE - 1);
+}
+
+void FUNC_RAM(ssd1306_rect_fixo)(uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  for (uint8_t x = left; x < left + width; ++x) {
+    ssd1306_pixel_fixo(x, top, value);
+    ssd1306_pixel_fixo(x, top + height - 1, value);
+  }
+  for (uint8_t y = top; y < top + height; ++y) {
+    ssd1306_pixel_fixo(left, y, value);
+    ssd1306_pixel_fixo(left + width - 1, y, value);
+  }
+
+  if (fill) {
+    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
+      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
+        ssd1306_pixel_fixo(x, y, value);
+      }
+    }
+  }
+}
+
+void FUNC_RAM(ssd1306_hline_fixo)(uint8_t x0, uint8_t x1, uint8_t y, bool value) {
+  for (uint8_t x = x0; x <= x1; ++x)
+    ssd1306_pixel_fixo(x, y, value);
+}
+
+void FUNC_RAM(ssd1306_vline_fixo)(uint8_t x, uint8_t y0, uint8_t y1, bool value) {
+  for (uint8_t y = y0; y <= y1; ++y)
+    ssd1306_pixel_fixo(x, y, value);
+}
+
+// Desenha um caractere escrevendo cada coluna do glifo de uma vez (1 ou 2 páginas)
+void FUNC_RAM(ssd1306_draw_char_fixo)(char c, uint8_t x, uint8_t y)
+{
+  const uint8_t *glyph = &font[ssd1306_font_index(c)];
+  uint8_t page = y >> 3;
+  uint8_t shift = y & 0b111;
+
+  if (page >= SSD1306_FIXO_PAGES)
+    return;
+
+  for (uint8_t i = 0; i < 8 && x + i < WIDTH; ++i)
+  {
+    uint8_t *col = &ssd1306_fixo_buffer[1 + (x + i) * SSD1306_FIXO_PAGES + page];
+    uint8_t line = glyph[i];
+
+    col[0] = (col[0] & ~(0xFF << shift)) | (line << shift);
+    if (shift && page + 1 < SSD1306_FIXO_PAGES)
+      col[1] = (col[1] & ~(0xFF >> (8 - shift))) | (line >> (8 - shift));
+  }
+}
+
+void FUNC_RAM(ssd1306_draw_string_fixo)(const char *str, uint8_t x, uint8_t y)
+{
+  while (*str)
+  {
+    ssd1306_draw_char_fixo(*str++, x, y);
+    x += 8;
+    if (x + 8 >= WIDTH)
+    {
+      x = 0;
+      y += 8;
+    }
+    if (y + 8 >= HEIGHT)
+    {
+      break;
+    }
+  }
+}
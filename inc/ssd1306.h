@@ -46,4 +46,32 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
-void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
\ No newline at end of file
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
+
+// ---- Variante com geometria fixa (WIDTH x HEIGHT em tempo de compilação) ----
+// Usa um buffer estático alinhado e índices constantes; a API acima continua
+// disponível para displays de outros tamanhos.
+
+#define SSD1306_FIXO_PAGES (HEIGHT / 8)
+#define SSD1306_FIXO_BUFSIZE (SSD1306_FIXO_PAGES * WIDTH + 1)
+
+extern uint8_t ssd1306_fixo_buffer[SSD1306_FIXO_BUFSIZE];
+
+void ssd1306_init_fixo(ssd1306_t *ssd, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+
+__force_inline static void ssd1306_pixel_fixo(uint8_t x, uint8_t y, bool value) {
+  if (x >= WIDTH || y >= HEIGHT)
+    return;
+  uint8_t *byte = &ssd1306_fixo_buffer[1 + x * SSD1306_FIXO_PAGES + (y >> 3)];
+  if (value)
+    *byte |= (1 << (y & 0b111));
+  else
+    *byte &= ~(1 << (y & 0b111));
+}
+
+void ssd1306_fill_fixo(bool value);
+void ssd1306_rect_fixo(uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill);
+void ssd1306_hline_fixo(uint8_t x0, uint8_t x1, uint8_t y, bool value);
+void ssd1306_vline_fixo(uint8_t x, uint8_t y0, uint8_t y1, bool value);
+void ssd1306_draw_char_fixo(char c, uint8_t x, uint8_t y);
+void ssd1306_draw_string_fixo(const char *str, uint8_t x, uint8_t y);
@@ -0,0 +1,98 @@
+// Comparação no host entre o driver genérico do SSD1306 e a variante de geometria fixa (inc/ssd1306.c):
+// verifica se os buffers ficam idênticos byte a byte e mede o tempo de desenho de cada um
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "ssd1306.h"
+
+#define REPETICOES 20000 // Chamadas em cada medição
+
+// O envio por I2C não é exercitado no host
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)i2c; (void)addr; (void)src; (void)nostop;
+    return (int)len;
+}
+
+static double agora_ns() {
+    struct timespec t;
+    timespec_get(&t, TIME_UTC);
+    return (double)t.tv_sec * 1e9 + (double)t.tv_nsec;
+}
+
+// Preenche os dois buffers com o mesmo padrão (para detectar bits apagados indevidamente)
+static void padrao(ssd1306_t *gen) {
+    memset(&gen->ram_buffer[1], 0x5A, gen->bufsize - 1);
+    memset(&ssd1306_fixo_buffer[1], 0x5A, SSD1306_FIXO_BUFSIZE - 1);
+}
+
+int main() {
+    ssd1306_t gen, fixo;
+    const char *chars = "aZ09:. x";
+    int falhas = 0;
+    double inicio, t_gen, t_fixo;
+
+    ssd1306_init(&gen, WIDTH, HEIGHT, false, 0x3C, NULL);
+    ssd1306_init_fixo(&fixo, false, 0x3C, NULL);
+
+    // Igualdade byte a byte em todas as posições dentro da tela
+    for (int y = 0; y <= HEIGHT - 8; y++) {
+        for (int x = 0; x <= WIDTH - 8; x++) {
+            char c = chars[(x + y) % 8];
+
+            padrao(&gen);
+            ssd1306_draw_char(&gen, c, x, y);
+            ssd1306_draw_char_fixo(c, x, y);
+            falhas += memcmp(gen.ram_buffer, ssd1306_fixo_buffer, SSD1306_FIXO_BUFSIZE) != 0;
+
+            ssd1306_rect(&gen, y, x, 8, 8, (x & 2) != 0, (x & 1) != 0);
+            ssd1306_rect_fixo(y, x, 8, 8, (x & 2) != 0, (x & 1) != 0);
+            ssd1306_hline(&gen, x, x + 7, y, true);
+            ssd1306_hline_fixo(x, x + 7, y, true);
+            ssd1306_vline(&gen, x, y, y + 7, false);
+            ssd1306_vline_fixo(x, y, y + 7, false);
+            falhas += memcmp(gen.ram_buffer, ssd1306_fixo_buffer, SSD1306_FIXO_BUFSIZE) != 0;
+        }
+    }
+
+    ssd1306_fill(&gen, true);
+    ssd1306_fill_fixo(true);
+    falhas += memcmp(gen.ram_buffer, ssd1306_fixo_buffer, SSD1306_FIXO_BUFSIZE) != 0;
+
+    // Tempo de desenho de um quadro do ohmímetro (valores e faixas de cores)
+    inicio = agora_ns();
+    for (int i = 0; i < REPETICOES; i++) {
+        ssd1306_draw_string(&gen, "000123", 8, 53);
+        ssd1306_draw_string(&gen, "3.123", 76, 53);
+        ssd1306_draw_string(&gen, "marr", 10, 4 + (i & 1));
+    }
+    t_gen = (agora_ns() - inicio) / REPETICOES;
+
+    inicio = agora_ns();
+    for (int i = 0; i < REPETICOES; i++) {
+        ssd1306_draw_string_fixo("000123", 8, 53);
+        ssd1306_draw_string_fixo("3.123", 76, 53);
+        ssd1306_draw_string_fixo("marr", 10, 4 + (i & 1));
+    }
+    t_fixo = (agora_ns() - inicio) / REPETICOES;
+
+    printf("Desenho de quadro: generico %.0f ns / fixo %.0f ns (%.1fx)\n", t_gen, t_fixo, t_gen / t_fixo);
+
+    inicio = agora_ns();
+    for (int i = 0; i < REPETICOES; i++) ssd1306_fill(&gen, i & 1);
+    t_gen = (agora_ns() - inicio) / REPETICOES;
+
+    inicio = agora_ns();
+    for (int i = 0; i < REPETICOES; i++) ssd1306_fill_fixo(i & 1);
+    t_fixo = (agora_ns() - inicio) / REPETICOES;
+
+    printf("Limpeza da tela: generico %.0f ns / fixo %.0f ns\n", t_gen, t_fixo);
+
+    if (falhas) {
+        printf("FALHA: %d posicao(oes) com buffers diferentes\n", falhas);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,4 @@
+// Substituto mínimo de hardware/i2c.h para compilar o driver do display no host
+typedef struct i2c_inst i2c_inst_t;
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
@@ -0,0 +1,7 @@
+// Substituto mínimo de pico/stdlib.h para compilar o driver do display no host
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define __not_in_flash_func(func_name) func_name // No host não há XIP: a função fica onde estiver
+#define __force_inline inline __attribute__((always_inline))
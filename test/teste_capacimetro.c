@@ -0,0 +1,98 @@
+// Teste e benchmark no host do ajuste da curva de carga RC (inc/capacimetro.c)
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+#include "capacimetro.h"
+
+#define AMOSTRAS 4096    // Mesmo tamanho da rajada do firmware
+#define V_FINAL 4040     // Platô abaixo do fundo de escala (GPIO e VREF são fontes diferentes)
+#define RUIDO 2          // Ruído máximo (± contagens)
+#define ERRO_MAX 0.01f   // Erro relativo máximo aceito no tau ajustado
+#define REPETICOES 2000  // Chamadas no benchmark
+
+static uint16_t curva[AMOSTRAS];
+static uint32_t semente = 12345;
+
+// Gerador pseudoaleatório simples (determinístico entre plataformas)
+static int ruido() {
+    semente = semente * 1103515245u + 12345u;
+    return (int)((semente >> 16) % (2 * RUIDO + 1)) - RUIDO;
+}
+
+// Gera v(t) = v_final * (1 - e^(-(t + atraso)/tau)) quantizada e com ruído
+static void gerar_curva(float tau, float atraso, uint16_t v_final) {
+    for (int i = 0; i < AMOSTRAS; i++) {
+        double v = v_final * (1.0 - exp(-((double)i + atraso) / tau)) + ruido();
+        if (v < 0) v = 0;
+        if (v > 4095) v = 4095;
+        curva[i] = (uint16_t)(v + 0.5);
+    }
+}
+
+static int falhas = 0;
+
+static void verificar_resultado(const char *nome, cap_resultado_t obtido, cap_resultado_t esperado) {
+    if (obtido != esperado) {
+        printf("FALHA %s: resultado %d, esperado %d\n", nome, obtido, esperado);
+        falhas++;
+    }
+}
+
+static double agora_ns() {
+    struct timespec t;
+    timespec_get(&t, TIME_UTC);
+    return (double)t.tv_sec * 1e9 + (double)t.tv_nsec;
+}
+
+int main() {
+    const float taus[] = {5, 10, 20, 50, 100, 200, 500, 1000, 1200, 1500};
+    const int n = sizeof(taus) / sizeof(taus[0]);
+    float tau, erro;
+    double inicio;
+
+    cap_iniciar();
+
+    // Precisão do ajuste em toda a faixa de tau
+    for (int i = 0; i < n; i++) {
+        gerar_curva(taus[i], 0.37f, V_FINAL);
+        tau = 0.0f;
+        verificar_resultado("ajuste", cap_ajustar_tau(curva, AMOSTRAS, V_FINAL, &tau), CAP_OK);
+        erro = fabsf(tau - taus[i]) / taus[i];
+        printf("tau %7.1f -> %8.2f (erro %.3f%%)\n", taus[i], tau, erro * 100.0f);
+        if (erro > ERRO_MAX) {
+            printf("FALHA ajuste: erro acima de %.1f%%\n", ERRO_MAX * 100.0f);
+            falhas++;
+        }
+    }
+
+    // Classificação das curvas fora da faixa
+    gerar_curva(1.0f, 0.0f, V_FINAL);
+    verificar_resultado("rapido", cap_ajustar_tau(curva, AMOSTRAS, V_FINAL, &tau), CAP_RAPIDO);
+
+    gerar_curva(5000.0f, 0.0f, V_FINAL);
+    verificar_resultado("lento", cap_ajustar_tau(curva, AMOSTRAS, V_FINAL, &tau), CAP_LENTO);
+
+    gerar_curva(1e9f, 0.0f, V_FINAL);
+    verificar_resultado("sem sinal", cap_ajustar_tau(curva, AMOSTRAS, V_FINAL, &tau), CAP_SEM_SINAL);
+
+    gerar_curva(10.0f, 0.0f, 3); // Curto: o platô medido também fica perto de zero
+    verificar_resultado("curto", cap_ajustar_tau(curva, AMOSTRAS, 3, &tau), CAP_SEM_SINAL);
+
+    // Benchmark: pior caso (curva lenta, quase todas as amostras na faixa de 10% a 90%)
+    gerar_curva(1200.0f, 0.0f, V_FINAL);
+    inicio = agora_ns();
+    for (int i = 0; i < REPETICOES; i++) {
+        cap_ajustar_tau(curva, AMOSTRAS, V_FINAL, &tau);
+    }
+    printf("cap_ajustar_tau: %.1f us por chamada (%d amostras)\n",
+           (agora_ns() - inicio) / REPETICOES / 1000.0, AMOSTRAS);
+
+    if (falhas) {
+        printf("%d falha(s)\n", falhas);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}